@@ -3,6 +3,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <raylib.h>
 #include<raymath.h>
 // C++ LIBS
@@ -14,6 +15,14 @@
 #include <chrono>
 #include <iostream>
 #include <deque>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <type_traits>
 
 const uint8_t FPS = 60;
 
@@ -25,7 +34,6 @@ void LogErrorMessage(const char* message) {
 	fprintf(stderr, "DISUNITY:::ERROR::: %s\n",message);
 }
 
-Transform t;
 typedef uint64_t EntityId;
 
 // RigidBody Component
@@ -113,45 +121,163 @@ typedef enum eventType_t {
 
 // Event Callback declaration
 typedef struct eventCallback_t;
-typedef void (EventCallback)(void* data);
+typedef void (EventCallback)(void* data, bool trace);
 
 // Event Manager
 typedef struct eventManager_t {
 	std::unordered_map<EventType, std::vector<EventCallback*>>Subscribers;
 } EventManager;
 
+// Input Keys -> One Bit Per Key The Game Reacts To So A Tick Of Input Fits In A Byte
+typedef enum inputKey_t {
+	INPUT_UP = 1 << 0,
+	INPUT_LEFT = 1 << 1,
+	INPUT_DOWN = 1 << 2,
+	INPUT_RIGHT = 1 << 3,
+	INPUT_ACTION = 1 << 4
+} InputKey;
+
+// Input Mode -> Live Polls The Keyboard, Record Polls And Logs, Replay Reads The Log Headless, None Holds No Keys
+typedef enum inputMode_t {
+	INPUT_LIVE,
+	INPUT_RECORD,
+	INPUT_REPLAY,
+	INPUT_NONE
+} InputMode;
+
+// Input Change -> Only Logged On Ticks Where The Held Keys Differ From The Previous Tick
+typedef struct inputChange_t {
+	uint32_t tick;
+	uint8_t keys;
+} InputChange;
+
+// Input Log -> A Recorded Session Plus The World Hash After Every Tick
+typedef struct inputLog_t {
+	uint32_t fps = FPS;
+	uint32_t tickCount = 0;
+	std::vector<InputChange> changes;
+	std::vector<uint64_t> worldHashes;
+} InputLog;
+
+// Input Manager
+typedef struct inputManager_t {
+	InputMode mode = INPUT_LIVE;
+	std::string logPath;
+	InputLog log;						// written while recording
+	const InputLog* replayLog = nullptr;	// read while replaying, many worlds can share one
+	uint32_t tick = 0;
+	size_t replayCursor = 0;
+	uint8_t keys = 0;
+} InputManager;
+
+// Memory Stats For One Subsystem Or Component Type, Container Internals Are Estimated Not Measured
+typedef struct memoryStats_t {
+	const char* name;
+	size_t liveCount;
+	size_t capacity;		// entries that fit before the container has to grow
+	size_t bytesUsed;		// payload bytes including heap owned by the payload (non-SSO strings etc)
+	size_t bytesOverhead;	// node links, buckets, allocator rounding and reserved but unused slots
+	int64_t liveGrowth;		// live count change since the previous report
+} MemoryStats;
+
+// Memory Report -> Allocation Counts Are Per Frame Totals For The Whole World, Not Split By Subsystem
+typedef struct memoryReport_t {
+	uint64_t frame;
+	std::vector<MemoryStats> subsystems;
+	size_t textureGpuBytes;
+	uint64_t lastFrameAllocations;
+	uint64_t peakFrameAllocations;		// biggest single frame since the last report window reset
+	double averageFrameAllocations;
+} MemoryReport;
+
+// Memory Telemetry -> Per Frame Allocation Counters Plus What The Previous Report Saw
+typedef struct memoryTelemetry_t {
+	uint32_t dumpInterval = 0; // ticks between dumps in headless mode, 0 only dumps at the end
+	uint64_t frame = 0;
+	uint64_t frameStartAllocations = 0;
+	uint64_t lastFrameAllocations = 0;
+	uint64_t peakFrameAllocations = 0;
+	uint64_t allocationsSinceReport = 0;
+	uint64_t framesSinceReport = 0;
+	std::vector<size_t> previousLiveCounts;
+} MemoryTelemetry;
+
+
+// World -> Everything One Simulation Owns, Worlds Share Nothing So Many Can Step In Parallel
+typedef struct world_t {
+	uint32_t id = 0;
+	uint32_t fps = FPS;
+	double deltaTime = 0.0;
+	bool diverged = false;
+	bool trace = true; // per tick prints from systems and event callbacks
+	// Step Timing, Only Written By Whoever Steps The World
+	uint64_t stepCount = 0;
+	double stepMicroseconds = 0.0;
+	// Entity List Basically Handles Removing/Adding Entities
+	EntityManger entityManager;
+	// Components HashMap That Contains Each Component
+	ComponentRegistry components;
+	// Asset Manager
+	AssetManager assetManager;
+	// Event Manager
+	EventManager eventManager;
+	// Input Manager Handles Recording And Replaying Input
+	InputManager inputManager;
+	// Memory Telemetry
+	MemoryTelemetry telemetry;
+} World;
 
 typedef struct engine_t {
 	// FPS And Window Config
 	uint32_t windowHeight = 1600;
 	uint32_t windowWidth  = 800;
-	uint8_t fps = FPS;
+	uint32_t fps = FPS;
 	double previousFrameTime = GetTime();
 	double currentFrameTime = 0.0;
-	double deltaTime = 0.0 ;
 	bool isRunning = false;
 	// Member Functions For Debugging Etc
 	void(*DebugPrint)(const char* message);
 	void(*ErrorPrint)(const char* message);
-	// Entity List Basically Handles Removing/Adding Entities
-	EntityManger entityManager;
-	// Components HashMap That Contains Each Component
-	ComponentRegistry components;
-	// Asset Manager
-	AssetManager assetManager;
-	// Event Manager
-	EventManager eventManager;
+	// The World Shown In The Window
+	World world;
 } Engine;
 
+// World Host -> Steps Every World Once Per Tick Across A Pool Of Worker Threads
+typedef struct worldHost_t {
+	std::deque<World> worlds; // deque so world addresses stay put
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable tickStart;
+	std::condition_variable tickDone;
+	uint64_t tick = 0;
+	std::atomic<size_t> nextWorld{ 0 };
+	uint32_t busyWorkers = 0;
+	bool shuttingDown = false;
+} WorldHost;
+
 // Function Declarations
 
 // Engine Function Declarations
-bool InitEngine();
-bool UninitEngine();
-
-void ProcessInput();
-void Render();
-void Update();
+bool InitEngine(Engine* engine);
+bool UninitEngine(Engine* engine);
+void EngineLoop(Engine* engine);
+void Update(Engine* engine);
+
+// World Function Declarations
+void InitWorld(World* world);
+void LoadLevel(uint32_t level, World* world);
+void ProcessInput(World* world);
+void UpdateWorld(World* world, double deltaTime);
+void Render(World* world);
+bool StepWorld(World* world);
+int ReplayWorld(World* world);
+
+// World Host Function Declarations
+void StartWorldHost(WorldHost* host, uint32_t threadCount);
+void StopWorldHost(WorldHost* host);
+void StepWorlds(WorldHost* host);
+void DumpWorldsMemory(WorldHost* host);
+int BenchmarkWorlds(uint32_t worldCount, uint32_t threadCount, uint32_t tickRate, uint32_t ticks, uint32_t dumpInterval, const InputLog* log);
 
 // Entity Functions
 EntityId CreateEntity(EntityManger* entities, ComponentRegistry* registry);
@@ -167,17 +293,17 @@ void AnimationComponentAddEntity(ComponentRegistry * registry, EntityId entityId
 void BoxColliderComponentAddEntity(ComponentRegistry * registry, EntityId entityId, BoxCollider boxCollider);
 
 // System Functions
-void UpdateHealthSystem(EntityManger* entities, ComponentRegistry* registry);;
-void UpdateMovementSystem(EntityManger* entities, ComponentRegistry* registry, double deltaTime);
-void UpdateRenderSystem(EntityManger* entities, ComponentRegistry* registry, AssetManager* assetManager);
-void UpdateAnimationSystem(EntityManger* entities, ComponentRegistry* registry, double deltaTime);
-void UpdateBoxCollisionSystem(EntityManger* entities, ComponentRegistry* registry,EventManager* eventManager);
-void UpdateDebugBoxCollisionsSystem(EntityManger* entities, ComponentRegistry* registry);
+void UpdateHealthSystem(EntityManger* entities, ComponentRegistry* registry, bool trace);
+void UpdateMovementSystem(EntityManger* entities, ComponentRegistry* registry, double deltaTime, bool trace);
+void UpdateRenderSystem(EntityManger* entities, ComponentRegistry* registry, AssetManager* assetManager, bool trace);
+void UpdateAnimationSystem(EntityManger* entities, ComponentRegistry* registry, double deltaTime, bool trace);
+void UpdateBoxCollisionSystem(EntityManger* entities, ComponentRegistry* registry,EventManager* eventManager, bool trace);
+void UpdateDebugBoxCollisionsSystem(EntityManger* entities, ComponentRegistry* registry, bool trace);
 void UpdateKeyboardControlSystem(EntityManger* entities, ComponentRegistry* registry,EventManager* eventManager);
 
 // SystemEventCallbacks
 
-void HealthSystemEventCallback(void* thedata);
+void HealthSystemEventCallback(void* thedata, bool trace);
 
 // Asset Manager Functions 
 void AddTexture(AssetManager* assets,const std::string& assetId, const std::string& filePath);
@@ -187,7 +313,24 @@ Texture GetTexture(AssetManager*assets,const std::string& assetId);
 // EventManger Functions
 void ClearEvents(EventManager* eventManager);
 void SubscribeToEvent(EventManager* eventManager, EventType etype, EventCallback* callback);
-void EmitEvent(EventManager* eventManager, EventType etype, void* data);
+void EmitEvent(EventManager* eventManager, EventType etype, void* data, bool trace);
+
+// InputManager Functions
+uint8_t PollInputKeys();
+uint8_t NextInputKeys(InputManager* input);
+void ApplyInput(World* world, uint8_t keys);
+bool EndInputTick(InputManager* input, uint64_t worldHash);
+bool SaveInputLog(const InputLog* log, const std::string& filePath);
+bool LoadInputLog(InputLog* log, const std::string& filePath);
+uint64_t HashWorld(EntityManger* entities, ComponentRegistry* registry);
+
+// Memory Telemetry Functions
+void BeginMemoryFrame(MemoryTelemetry* telemetry);
+void EndMemoryFrame(MemoryTelemetry* telemetry);
+MemoryReport SampleMemory(const World* world);
+void ResetMemoryReportWindow(MemoryTelemetry* telemetry, const MemoryReport* report);
+void AddMemoryReport(MemoryReport* total, const MemoryReport* report);
+void PrintMemoryReport(const MemoryReport* report);
 
 // UtilityFunctions
 bool CheckAABBCollision(double aX, double aY, double aW, double aH, double bX, double bY, double bW, double bH);
@@ -203,11 +346,11 @@ void SubscribeToEvent(EventManager* eventManager, EventType etype, EventCallback
 	eventManager->Subscribers[etype].push_back(callback);
 }
 
-void EmitEvent(EventManager* eventManager, EventType etype, void* eventData) {
+void EmitEvent(EventManager* eventManager, EventType etype, void* eventData, bool trace) {
 	try {
 		std::vector<EventCallback*> subscribers = eventManager->Subscribers[etype];
 		for (auto &callback : subscribers) {
-			(*callback)(eventData); // perform the callback
+			(*callback)(eventData, trace); // perform the callback
 		}
 	}
 	catch (...) {
@@ -216,12 +359,12 @@ void EmitEvent(EventManager* eventManager, EventType etype, void* eventData) {
 }
 
 //Event Callback Functions
-void HealthSystemEventCallback(void* thedata) {
-	printf("HealthSystemEvenCalback Called");
+void HealthSystemEventCallback(void* thedata, bool trace) {
+	if (trace) printf("HealthSystemEvenCalback Called");
 }
-void KeyboardControlSystemEventCallback(void* data) {
+void KeyboardControlSystemEventCallback(void* data, bool trace) {
 	KeyBoardEvent* evt = (KeyBoardEvent*)data;
-	printf("KeyboardControlSystemEventCallback Called\n");
+	if (trace) printf("KeyboardControlSystemEventCallback Called\n");
 }
 
 bool CheckAABBCollision(double aX, double aY, double aW, double aH, double bX, double bY, double bW, double bH) {
@@ -233,14 +376,395 @@ bool CheckAABBCollision(double aX, double aY, double aW, double aH, double bX, d
 		);
 }
 
+uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+	// FNV-1a
+	const uint8_t* bytes = (const uint8_t*)data;
+	for (size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+// Hash Of Everything The Simulation Mutates, Fields Are Hashed One By One So Struct Padding Is Never Read
+uint64_t HashWorld(EntityManger* entities, ComponentRegistry* registry) {
+	uint64_t hash = 14695981039346656037ULL;
+	// Hash Map Order Is Not Something To Rely On So Walk Entities Sorted
+	std::vector<EntityId>ids;
+	for (auto it = entities->Entities.begin(); it != entities->Entities.end(); it++) {
+		ids.push_back(it->first);
+	}
+	std::sort(ids.begin(), ids.end());
+	for (EntityId i : ids) {
+		bool purged = entities->Entities.at(i);
+		hash = HashBytes(hash, &i, sizeof(i));
+		hash = HashBytes(hash, &purged, sizeof(purged));
+		auto transform = registry->TransformComponents.find(i);
+		if (transform != registry->TransformComponents.end()) {
+			hash = HashBytes(hash, &transform->second.position, sizeof(Vector2));
+			hash = HashBytes(hash, &transform->second.direction, sizeof(Vector2));
+			hash = HashBytes(hash, &transform->second.scale, sizeof(float));
+			hash = HashBytes(hash, &transform->second.rotation, sizeof(double));
+		}
+		auto rigidBody = registry->RigidBodyComponents.find(i);
+		if (rigidBody != registry->RigidBodyComponents.end()) {
+			hash = HashBytes(hash, &rigidBody->second.velocity, sizeof(Vector2));
+		}
+		auto health = registry->HealthComponents.find(i);
+		if (health != registry->HealthComponents.end()) {
+			hash = HashBytes(hash, &health->second.currentHealth, sizeof(uint32_t));
+			hash = HashBytes(hash, &health->second.maxHealth, sizeof(uint32_t));
+		}
+		auto animation = registry->AnimationComponents.find(i);
+		if (animation != registry->AnimationComponents.end()) {
+			hash = HashBytes(hash, &animation->second.currentFrame, sizeof(uint32_t));
+			hash = HashBytes(hash, &animation->second.runningTime, sizeof(float));
+		}
+		auto sprite = registry->SpriteComponents.find(i);
+		if (sprite != registry->SpriteComponents.end()) {
+			hash = HashBytes(hash, &sprite->second.box, sizeof(Rectangle));
+		}
+	}
+	return hash;
+}
+
+// Input Functions
+uint8_t PollInputKeys() {
+	uint8_t keys = 0;
+	if (IsKeyDown(KEY_W)) keys |= INPUT_UP;
+	if (IsKeyDown(KEY_A)) keys |= INPUT_LEFT;
+	if (IsKeyDown(KEY_S)) keys |= INPUT_DOWN;
+	if (IsKeyDown(KEY_D)) keys |= INPUT_RIGHT;
+	if (IsKeyDown(KEY_SPACE)) keys |= INPUT_ACTION;
+	return keys;
+}
+
+// Returns The Keys Held For The Current Tick Depending On Input Mode
+uint8_t NextInputKeys(InputManager* input) {
+	if (input->mode == INPUT_REPLAY) {
+		// Changes Are Sorted By Tick So Just Advance The Cursor
+		while (input->replayCursor < input->replayLog->changes.size() && input->replayLog->changes[input->replayCursor].tick <= input->tick) {
+			input->keys = input->replayLog->changes[input->replayCursor].keys;
+			input->replayCursor++;
+		}
+		return input->keys;
+	}
+	if (input->mode == INPUT_NONE) {
+		return 0;
+	}
+	uint8_t keys = PollInputKeys();
+	if (input->mode == INPUT_RECORD && (keys != input->keys || input->log.changes.empty())) {
+		input->log.changes.push_back({ input->tick, keys });
+	}
+	input->keys = keys;
+	return keys;
+}
+
+// Closes The Current Tick, Returns False If A Replay Diverged From The Recording
+bool EndInputTick(InputManager* input, uint64_t worldHash) {
+	if (input->mode == INPUT_RECORD) {
+		input->log.worldHashes.push_back(worldHash);
+		input->log.tickCount++;
+	}
+	else if (input->mode == INPUT_REPLAY) {
+		const std::vector<uint64_t>& worldHashes = input->replayLog->worldHashes;
+		if (input->tick >= worldHashes.size() || worldHashes[input->tick] != worldHash) {
+			uint64_t expected = input->tick < worldHashes.size() ? worldHashes[input->tick] : 0;
+			fprintf(stderr, "DISUNITY:::ERROR::: Replay Diverged At Tick %u Expected %016llx Got %016llx\n", input->tick,
+				(unsigned long long)expected, (unsigned long long)worldHash);
+			return false;
+		}
+	}
+	input->tick++;
+	return true;
+}
+
+// Log Layout -> "DSIN" version fps tickCount changeCount, changeCount * { tick keys }, tickCount * hash
+// Fields Are Written In Native Byte Order, So A Log Only Replays On The Same Kind Of Machine That Recorded It
+bool SaveInputLog(const InputLog* log, const std::string& filePath) {
+	std::ofstream file(filePath, std::ios::binary);
+	if (!file) {
+		LogErrorMessage("Failed To Open Input Log For Writing");
+		return false;
+	}
+	uint32_t version = 1;
+	uint32_t changeCount = (uint32_t)log->changes.size();
+	file.write("DSIN", 4);
+	file.write((const char*)&version, sizeof(version));
+	file.write((const char*)&log->fps, sizeof(log->fps));
+	file.write((const char*)&log->tickCount, sizeof(log->tickCount));
+	file.write((const char*)&changeCount, sizeof(changeCount));
+	for (const InputChange& change : log->changes) {
+		file.write((const char*)&change.tick, sizeof(change.tick));
+		file.write((const char*)&change.keys, sizeof(change.keys));
+	}
+	file.write((const char*)log->worldHashes.data(), log->worldHashes.size() * sizeof(uint64_t));
+	return file.good();
+}
+
+bool LoadInputLog(InputLog* log, const std::string& filePath) {
+	std::ifstream file(filePath, std::ios::binary);
+	if (!file) {
+		LogErrorMessage("Failed To Open Input Log For Reading");
+		return false;
+	}
+	char magic[4] = {};
+	uint32_t version = 0;
+	uint32_t changeCount = 0;
+	file.read(magic, 4);
+	file.read((char*)&version, sizeof(version));
+	if (!file || memcmp(magic, "DSIN", 4) != 0 || version != 1) {
+		LogErrorMessage("Input Log Has Bad Header");
+		return false;
+	}
+	file.read((char*)&log->fps, sizeof(log->fps));
+	file.read((char*)&log->tickCount, sizeof(log->tickCount));
+	file.read((char*)&changeCount, sizeof(changeCount));
+	// Check The Counts Against What Is Left In The File Before Allocating For Them
+	std::streamoff headerEnd = file.tellg();
+	file.seekg(0, std::ios::end);
+	uint64_t remaining = (uint64_t)(file.tellg() - headerEnd);
+	file.seekg(headerEnd);
+	uint64_t expected = (uint64_t)changeCount * (sizeof(uint32_t) + sizeof(uint8_t)) + (uint64_t)log->tickCount * sizeof(uint64_t);
+	if (!file || headerEnd < 0 || expected > remaining) {
+		LogErrorMessage("Input Log Is Truncated");
+		return false;
+	}
+	log->changes.resize(changeCount);
+	for (InputChange& change : log->changes) {
+		file.read((char*)&change.tick, sizeof(change.tick));
+		file.read((char*)&change.keys, sizeof(change.keys));
+	}
+	log->worldHashes.resize(log->tickCount);
+	file.read((char*)log->worldHashes.data(), log->worldHashes.size() * sizeof(uint64_t));
+	if (!file || log->fps == 0) {
+		LogErrorMessage("Input Log Is Truncated");
+		return false;
+	}
+	return true;
+}
 
-// Globals
-Engine Disunity;
+// Allocation Counter -> Every Heap Allocation Goes Through These, Counted Per Thread So A World Only Sees Its Own
+thread_local uint64_t HeapAllocations = 0;
+
+// GCC Flags free() On Memory From operator new, Which Is Exactly What A Replacement Allocator Does
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(size_t size) {
+	HeapAllocations++;
+	void* block = malloc(size ? size : 1);
+	if (!block) throw std::bad_alloc();
+	return block;
+}
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+void operator delete(void* block) noexcept {
+	free(block);
+}
+void operator delete[](void* block) noexcept {
+	free(block);
+}
+void operator delete(void* block, size_t) noexcept {
+	free(block);
+}
+void operator delete[](void* block, size_t) noexcept {
+	free(block);
+}
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+void BeginMemoryFrame(MemoryTelemetry* telemetry) {
+	telemetry->frameStartAllocations = HeapAllocations;
+}
+
+void EndMemoryFrame(MemoryTelemetry* telemetry) {
+	uint64_t allocations = HeapAllocations - telemetry->frameStartAllocations;
+	telemetry->lastFrameAllocations = allocations;
+	telemetry->peakFrameAllocations = std::max(telemetry->peakFrameAllocations, allocations);
+	telemetry->allocationsSinceReport += allocations;
+	telemetry->framesSinceReport++;
+	telemetry->frame++;
+}
+
+// Heap Chunk A Request Really Takes, Including The Allocator's Own Header
+size_t HeapBlockBytes(size_t size) {
+#ifdef _MSC_VER
+	// Windows heap: a two pointer block header, blocks come in two pointer granules
+	const size_t granule = 2 * sizeof(void*);
+	return (size + 2 * sizeof(void*) + granule - 1) & ~(granule - 1);
+#else
+	// glibc: a size_t chunk header, 16 byte alignment and a 32 byte minimum chunk (32 -> 48, 64 -> 80)
+	return std::max((size + sizeof(size_t) + 15) & ~(size_t)15, (size_t)32);
+#endif
+}
+
+// Short Strings Live Inside The Object, Anything Longer Owns A Heap Block
+size_t StringHeapBytes(const std::string& str) {
+	const char* data = str.data();
+	if (data >= (const char*)&str && data < (const char*)(&str + 1)) return 0;
+	return HeapBlockBytes(str.capacity() + 1);
+}
+
+// Hash Map Estimate -> Each Entry Is A Heap Node With Links, Plus The Bucket Array
+template<typename Map>
+MemoryStats MapMemoryStats(const char* name, const Map& map) {
+#ifdef _MSC_VER
+	const size_t nodeLinkBytes = 2 * sizeof(void*);		// doubly linked list node
+	const size_t bucketBytes = 2 * sizeof(void*);		// first/last iterator per bucket
+#else
+	// libstdc++ Also Caches The Hash In Each Node When Hashing Is Slow, Which Means String Keys
+	const size_t nodeLinkBytes = sizeof(void*) + (std::is_same<typename Map::key_type, std::string>::value ? sizeof(size_t) : 0);
+	const size_t bucketBytes = sizeof(void*);
+#endif
+	size_t valueBytes = sizeof(typename Map::value_type);
+	MemoryStats stats = {};
+	stats.name = name;
+	stats.liveCount = map.size();
+	stats.capacity = (size_t)(map.bucket_count() * map.max_load_factor());
+	stats.bytesUsed = map.size() * valueBytes;
+	stats.bytesOverhead = map.size() * (HeapBlockBytes(valueBytes + nodeLinkBytes) - valueBytes) + map.bucket_count() * bucketBytes;
+	return stats;
+}
+
+// Deque Estimate -> Elements Live In Fixed Size Blocks Reached Through A Map Array Of Block Pointers
+template<typename Deque>
+MemoryStats DequeMemoryStats(const char* name, const Deque& deque) {
+	size_t valueBytes = sizeof(typename Deque::value_type);
+#ifdef _MSC_VER
+	// 16 byte blocks, one element per block once elements are bigger than 8 bytes
+	size_t blockElements = valueBytes <= 1 ? 16 : valueBytes <= 2 ? 8 : valueBytes <= 4 ? 4 : valueBytes <= 8 ? 2 : 1;
+#else
+	// 512 byte blocks, or a single element when it is bigger than that
+	size_t blockElements = valueBytes < 512 ? 512 / valueBytes : 1;
+#endif
+	// Both Keep At Least One Spare Block And A Map Of At Least 8 Pointers
+	size_t blocks = deque.size() / blockElements + 1;
+	size_t mapPointers = std::max(blocks + 2, (size_t)8);
+	MemoryStats stats = {};
+	stats.name = name;
+	stats.liveCount = deque.size();
+	stats.capacity = blocks * blockElements;
+	stats.bytesUsed = deque.size() * valueBytes;
+	stats.bytesOverhead = (stats.capacity - deque.size()) * valueBytes + mapPointers * sizeof(void*);
+	return stats;
+}
+
+// GPU Size Of A Texture Including Its Mip Chain
+size_t TextureGpuBytes(const Texture& texture) {
+	size_t bytes = 0;
+	int width = texture.width;
+	int height = texture.height;
+	for (int level = 0; level < std::max(texture.mipmaps, 1); level++) {
+		bytes += GetPixelDataSize(width, height, texture.format);
+		width = std::max(width / 2, 1);
+		height = std::max(height / 2, 1);
+	}
+	return bytes;
+}
+
+// Read Only Snapshot, Growth And Average Allocations Are Relative To The Last ResetMemoryReportWindow
+MemoryReport SampleMemory(const World* world) {
+	MemoryReport report = {};
+	const MemoryTelemetry* telemetry = &world->telemetry;
+	const ComponentRegistry* registry = &world->components;
+	report.frame = telemetry->frame;
+	report.subsystems.push_back(MapMemoryStats("Entities", world->entityManager.Entities));
+	report.subsystems.push_back(DequeMemoryStats("FreeEntityIds", registry->FreeEntityIds));
+	report.subsystems.push_back(MapMemoryStats("HealthComponents", registry->HealthComponents));
+	report.subsystems.push_back(MapMemoryStats("TransformComponents", registry->TransformComponents));
+	report.subsystems.push_back(MapMemoryStats("RigidBodyComponents", registry->RigidBodyComponents));
+	MemoryStats sprites = MapMemoryStats("SpriteComponents", registry->SpriteComponents);
+	for (auto it = registry->SpriteComponents.begin(); it != registry->SpriteComponents.end(); it++) {
+		sprites.bytesUsed += StringHeapBytes(it->second.assetId);
+	}
+	report.subsystems.push_back(sprites);
+	report.subsystems.push_back(MapMemoryStats("AnimationComponents", registry->AnimationComponents));
+	report.subsystems.push_back(MapMemoryStats("BoxColliderComponents", registry->BoxColliderComponents));
+	MemoryStats textures = MapMemoryStats("Textures", world->assetManager.Textures);
+	for (auto it = world->assetManager.Textures.begin(); it != world->assetManager.Textures.end(); it++) {
+		textures.bytesUsed += StringHeapBytes(it->first);
+		report.textureGpuBytes += TextureGpuBytes(it->second);
+	}
+	report.subsystems.push_back(textures);
+	MemoryStats subscribers = MapMemoryStats("Subscribers", world->eventManager.Subscribers);
+	for (auto it = world->eventManager.Subscribers.begin(); it != world->eventManager.Subscribers.end(); it++) {
+		subscribers.bytesUsed += it->second.size() * sizeof(EventCallback*);
+		subscribers.bytesOverhead += (it->second.capacity() - it->second.size()) * sizeof(EventCallback*);
+	}
+	report.subsystems.push_back(subscribers);
+	for (size_t i = 0; i < report.subsystems.size(); i++) {
+		size_t previous = i < telemetry->previousLiveCounts.size() ? telemetry->previousLiveCounts[i] : 0;
+		report.subsystems[i].liveGrowth = (int64_t)report.subsystems[i].liveCount - (int64_t)previous;
+	}
+	report.lastFrameAllocations = telemetry->lastFrameAllocations;
+	report.peakFrameAllocations = telemetry->peakFrameAllocations;
+	report.averageFrameAllocations = telemetry->framesSinceReport ? (double)telemetry->allocationsSinceReport / telemetry->framesSinceReport : 0.0;
+	return report;
+}
+
+// Starts A New Report Window, The Live Counts In report Become The Baseline For The Next Growth Figures
+void ResetMemoryReportWindow(MemoryTelemetry* telemetry, const MemoryReport* report) {
+	telemetry->previousLiveCounts.clear();
+	for (const MemoryStats& stats : report->subsystems) {
+		telemetry->previousLiveCounts.push_back(stats.liveCount);
+	}
+	telemetry->peakFrameAllocations = 0;
+	telemetry->allocationsSinceReport = 0;
+	telemetry->framesSinceReport = 0;
+}
+
+// Sums report Into total Field By Field, Used To Aggregate Many Worlds Into One Report
+// Peak Is The Exception, It Stays The Biggest Frame Any Single World Had Since Summing Peaks Matches No Real Frame
+void AddMemoryReport(MemoryReport* total, const MemoryReport* report) {
+	if (total->subsystems.empty()) {
+		total->subsystems = report->subsystems;
+	}
+	else {
+		for (size_t i = 0; i < total->subsystems.size() && i < report->subsystems.size(); i++) {
+			total->subsystems[i].liveCount += report->subsystems[i].liveCount;
+			total->subsystems[i].capacity += report->subsystems[i].capacity;
+			total->subsystems[i].bytesUsed += report->subsystems[i].bytesUsed;
+			total->subsystems[i].bytesOverhead += report->subsystems[i].bytesOverhead;
+			total->subsystems[i].liveGrowth += report->subsystems[i].liveGrowth;
+		}
+	}
+	total->textureGpuBytes += report->textureGpuBytes;
+	total->lastFrameAllocations += report->lastFrameAllocations;
+	total->peakFrameAllocations = std::max(total->peakFrameAllocations, report->peakFrameAllocations);
+	total->averageFrameAllocations += report->averageFrameAllocations;
+}
+
+void PrintMemoryReport(const MemoryReport* report) {
+	size_t totalUsed = 0;
+	size_t totalOverhead = 0;
+	fprintf(stderr, "DISUNITY:::MEMORY::: Frame %llu Allocations Last %llu Peak %llu Avg %.2f\n", (unsigned long long)report->frame,
+		(unsigned long long)report->lastFrameAllocations, (unsigned long long)report->peakFrameAllocations, report->averageFrameAllocations);
+	for (const MemoryStats& stats : report->subsystems) {
+		fprintf(stderr, "DISUNITY:::MEMORY::: %-22s live %8zu capacity %8zu used %10zu overhead %10zu growth %+lld\n", stats.name,
+			stats.liveCount, stats.capacity, stats.bytesUsed, stats.bytesOverhead, (long long)stats.liveGrowth);
+		totalUsed += stats.bytesUsed;
+		totalOverhead += stats.bytesOverhead;
+	}
+	fprintf(stderr, "DISUNITY:::MEMORY::: Total Used %zu Overhead %zu Texture GPU %zu\n", totalUsed, totalOverhead, report->textureGpuBytes);
+}
 
 // Implementations Of Functions
 
 void AddTexture(AssetManager* assets,const std::string& assetId, const std::string& filePath) {
 	// I think LoadTexture stored data on the heap....or in GPU memory....So I think below is ok.
+	if (!IsWindowReady()) {
+		// Headless -> No GL Context To Upload To So Only Keep The Image Dimensions
+		Image image = LoadImage(filePath.c_str());
+		Texture texture = { 0, image.width, image.height, image.mipmaps, image.format };
+		UnloadImage(image);
+		assets->Textures.insert({assetId,texture});
+		return;
+	}
 	Texture texture = LoadTexture(filePath.c_str());
 	assets->Textures.insert({assetId,texture});
 }
@@ -320,7 +844,7 @@ void PurgeEntities(EntityManger* entities,ComponentRegistry* registry) {
 
 
 // Systems
-void UpdateHealthSystem(EntityManger* entities,ComponentRegistry* registry) {
+void UpdateHealthSystem(EntityManger* entities,ComponentRegistry* registry, bool trace) {
 	std::vector<EntityId>ids;
 	// Get Alive Entity Ids
 	for (auto it = entities->Entities.begin(); it != entities->Entities.end(); it++) {
@@ -334,7 +858,7 @@ void UpdateHealthSystem(EntityManger* entities,ComponentRegistry* registry) {
 			// Update Entity Health Component
 			Health& h = registry->HealthComponents.at(i);
 			if (h.currentHealth == 0) {
-				printf("Your health is zero!");
+				if (trace) printf("Your health is zero!");
 				// Mark it as purged in entity Manager
 				entities->Entities[i] = true;
 			}
@@ -343,7 +867,7 @@ void UpdateHealthSystem(EntityManger* entities,ComponentRegistry* registry) {
 }
 
 // Movement System Requires { Transform, RigidBody }
-void UpdateMovementSystem(EntityManger* entities, ComponentRegistry* registry,double deltaTime) {
+void UpdateMovementSystem(EntityManger* entities, ComponentRegistry* registry,double deltaTime, bool trace) {
 	std::vector<EntityId>ids;
 	// Get Alive Entity Ids
 	for (auto it = entities->Entities.begin(); it != entities->Entities.end(); it++) {
@@ -365,7 +889,7 @@ void UpdateMovementSystem(EntityManger* entities, ComponentRegistry* registry,do
 			}
 			//transformer.position.x += rigidBody.velocity.x * deltaTime;
 			//transformer.position.y += rigidBody.velocity.y * deltaTime;
-			printf("Entity %d Position is now x %f y %f\n", (int)i, transformer.position.x, transformer.position.y);
+			if (trace) printf("Entity %d Position is now x %f y %f\n", (int)i, transformer.position.x, transformer.position.y);
 		}
 		catch (...) {
 			continue;
@@ -375,7 +899,7 @@ void UpdateMovementSystem(EntityManger* entities, ComponentRegistry* registry,do
 }
 
 // Render System Requires { Transform, Sprite}
-void UpdateRenderSystem(EntityManger* entities, ComponentRegistry* registry, AssetManager* assetManager) {
+void UpdateRenderSystem(EntityManger* entities, ComponentRegistry* registry, AssetManager* assetManager, bool trace) {
 	auto start = std::chrono::high_resolution_clock::now();
 	std::map<uint32_t,std::vector<EntityId>>ids;
 	// Get Alive Entity Ids That Have Sprite And Transform Component
@@ -416,10 +940,10 @@ void UpdateRenderSystem(EntityManger* entities, ComponentRegistry* registry, Ass
 	}
 	auto stop = std::chrono::high_resolution_clock::now();
 	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
-	std::cout << duration.count() << std::endl;
+	if (trace) std::cout << duration.count() << std::endl;
 }
 
-void UpdateAnimationSystem(EntityManger* entities, ComponentRegistry* registry,double deltaTime) {
+void UpdateAnimationSystem(EntityManger* entities, ComponentRegistry* registry,double deltaTime, bool trace) {
 	auto start = std::chrono::high_resolution_clock::now();
 	std::map<uint32_t,std::vector<EntityId>>ids;
 	// Get Alive Entity Ids That Have Sprite And Transform Component
@@ -446,11 +970,11 @@ void UpdateAnimationSystem(EntityManger* entities, ComponentRegistry* registry,d
 	}
 	auto stop = std::chrono::high_resolution_clock::now();
 	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
-	std::cout << duration.count() << std::endl;
+	if (trace) std::cout << duration.count() << std::endl;
 }
 
 // Box Collision System
-void UpdateBoxCollisionSystem(EntityManger* entities, ComponentRegistry* registry,EventManager* eventManager) {
+void UpdateBoxCollisionSystem(EntityManger* entities, ComponentRegistry* registry,EventManager* eventManager, bool trace) {
 	auto start = std::chrono::high_resolution_clock::now();
 	std::map<uint32_t,std::vector<EntityId>>ids;
 	std::vector<EntityId>collidableEntities;
@@ -481,18 +1005,18 @@ void UpdateBoxCollisionSystem(EntityManger* entities, ComponentRegistry* registr
 			bool collision = CheckAABBCollision(aTransform.position.x + aCollider.offset.x, aTransform.position.y + aCollider.offset.y, aCollider.width, aCollider.height, bTransform.position.x + bCollider.offset.x, bTransform.position.y + bCollider.offset.y, bCollider.width, bCollider.height);
 			if (collision) {
 				// Example Of Collision System
-				printf("COLLISION! EMITTING EVENT\n");
+				if (trace) printf("COLLISION! EMITTING EVENT\n");
 				CollisionEvent evt = { a,b };
-				EmitEvent(eventManager, COLLISION, &evt);
+				EmitEvent(eventManager, COLLISION, &evt, trace);
 			}
 		}
 	}
 	auto stop = std::chrono::high_resolution_clock::now();
 	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
-	std::cout << duration.count() << std::endl;
+	if (trace) std::cout << duration.count() << std::endl;
 }
 
-void UpdateDebugBoxCollisionsSystem(EntityManger* entities, ComponentRegistry* registry) {
+void UpdateDebugBoxCollisionsSystem(EntityManger* entities, ComponentRegistry* registry, bool trace) {
 	auto start = std::chrono::high_resolution_clock::now();
 	std::map<uint32_t,std::vector<EntityId>>ids;
 	std::vector<EntityId>collidableEntities;
@@ -522,17 +1046,17 @@ void UpdateDebugBoxCollisionsSystem(EntityManger* entities, ComponentRegistry* r
 	}
 	auto stop = std::chrono::high_resolution_clock::now();
 	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
-	std::cout << duration.count() << std::endl;
+	if (trace) std::cout << duration.count() << std::endl;
 }
 
 void UpdateKeyboardControlSystem(EntityManger* entities, ComponentRegistry* registry, EventManager* eventManager){
 	// TODO Currently Doesnt Do Anything
 }
 
-void LoadTileMap(Engine* Disunity,const std::string tilePath,uint32_t imageWidth,uint32_t imageHeight){
+void LoadTileMap(World* world,const std::string tilePath,uint32_t imageWidth,uint32_t imageHeight){
 	// Ok so we load 1 tilemap texture as 1 entity, we do not have each singular tile as an entity.
-	AddTexture(&Disunity->assetManager, "tile-map-image", tilePath);
-	EntityId tile = CreateEntity(&Disunity->entityManager,&Disunity->components);
+	AddTexture(&world->assetManager, "tile-map-image", tilePath);
+	EntityId tile = CreateEntity(&world->entityManager,&world->components);
 	// Add Components
 	Transformer tileTransformer = { tile, {0.0,0.0},{0,0}, 4.0, 0.0 };
 	Sprite tileSprite = {};
@@ -542,16 +1066,16 @@ void LoadTileMap(Engine* Disunity,const std::string tilePath,uint32_t imageWidth
 	tileSprite.box.y = 0;
 	tileSprite.assetId = "tile-map-image";
 	tileSprite.zIndex = 0;
-	TransformerComponentAddEntity(&Disunity->components, tile, tileTransformer);
-	SpriteComponentAddEntity(&Disunity->components, tile, tileSprite);
+	TransformerComponentAddEntity(&world->components, tile, tileTransformer);
+	SpriteComponentAddEntity(&world->components, tile, tileSprite);
 }
 
 
-void LoadLevel(uint32_t level, Engine* Disunity){
-	LoadTileMap(Disunity, "C:\\temp\\assets\\nature_tileset\\OpenWorldMap24x24.png",768,768);
-	EntityId tank = CreateEntity(&Disunity->entityManager,&Disunity->components);
-	EntityId truck = CreateEntity(&Disunity->entityManager,&Disunity->components);
-	EntityId knight = CreateEntity(&Disunity->entityManager,&Disunity->components);
+void LoadLevel(uint32_t level, World* world){
+	LoadTileMap(world, "C:\\temp\\assets\\nature_tileset\\OpenWorldMap24x24.png",768,768);
+	EntityId tank = CreateEntity(&world->entityManager,&world->components);
+	EntityId truck = CreateEntity(&world->entityManager,&world->components);
+	EntityId knight = CreateEntity(&world->entityManager,&world->components);
 	Transformer knightPos = { knight,{500.0,500.0},{0.f,0.f},3.4,0.0};
 	Vector2 knightVelocity = { 5.0,5.0 };
 	RigidBody knightBody = { knight,knightVelocity};
@@ -562,13 +1086,13 @@ void LoadLevel(uint32_t level, Engine* Disunity){
 	knightSprite.box.width = 16;
 	knightSprite.box.height = 16;
 	knightSprite.zIndex = 1;
-	TransformerComponentAddEntity(&Disunity->components, knight, knightPos);
-	RigidBodyComponentAddEntity(&Disunity->components,knight, knightBody);
-	SpriteComponentAddEntity(&Disunity->components, knight, knightSprite);
-	AnimationComponentAddEntity(&Disunity->components, knight, knightAnimation);
-	BoxColliderComponentAddEntity(&Disunity->components, knight, knightCollider);
-	AddTexture(&Disunity->assetManager, "knight-image", "C:\\temp\\assets\\characters\\knight_idle_spritesheet.png");
-	Disunity->DebugPrint("Created Entity");
+	TransformerComponentAddEntity(&world->components, knight, knightPos);
+	RigidBodyComponentAddEntity(&world->components,knight, knightBody);
+	SpriteComponentAddEntity(&world->components, knight, knightSprite);
+	AnimationComponentAddEntity(&world->components, knight, knightAnimation);
+	BoxColliderComponentAddEntity(&world->components, knight, knightCollider);
+	AddTexture(&world->assetManager, "knight-image", "C:\\temp\\assets\\characters\\knight_idle_spritesheet.png");
+	LogDebugMessage("Created Entity");
 	// Create data for tank sprite
 	float tankScale = 3.4;
 	Transformer tanktransformer = { tank,{10.0,30.0},{0.f,0.f},tankScale,0.0};
@@ -583,10 +1107,10 @@ void LoadLevel(uint32_t level, Engine* Disunity){
 	tankSprite.box.height = 32;
 	tankSprite.zIndex = 1;
 	// add components to tank entity
-	TransformerComponentAddEntity(&Disunity->components, tank, tanktransformer);
-	RigidBodyComponentAddEntity(&Disunity->components, tank, tankBody);
-	SpriteComponentAddEntity(&Disunity->components, tank, tankSprite);
-	BoxColliderComponentAddEntity(&Disunity->components, tank, tankCollider);
+	TransformerComponentAddEntity(&world->components, tank, tanktransformer);
+	RigidBodyComponentAddEntity(&world->components, tank, tankBody);
+	SpriteComponentAddEntity(&world->components, tank, tankSprite);
+	BoxColliderComponentAddEntity(&world->components, tank, tankCollider);
 	// create data for truck sprite
 	Transformer truckTransformer = { truck,{50.0,100.0},{0,0},3.0,45.0};
 	RigidBody truckBody = { truck,{10.0,50.0} };
@@ -597,124 +1121,396 @@ void LoadLevel(uint32_t level, Engine* Disunity){
 	truckSprite.box.height = 32;
 	truckSprite.zIndex = 1;
 	// add components to truck entity
-	TransformerComponentAddEntity(&Disunity->components, truck, truckTransformer);
-	RigidBodyComponentAddEntity(&Disunity->components, truck, truckBody);
-	SpriteComponentAddEntity(&Disunity->components, truck, truckSprite);
-}
-
-bool InitEngine() {
-	Disunity.DebugPrint = LogDebugMessage;
-	Disunity.ErrorPrint = LogErrorMessage;
-	Disunity.fps = FPS;
-	Disunity.isRunning = true;
-	Disunity.windowHeight = 800;
-	Disunity.windowWidth = 800;
-	InitWindow(Disunity.windowWidth, Disunity.windowHeight, "Disunity");
-	SetTargetFPS(Disunity.fps);
-	Disunity.DebugPrint("Initialized Engine");
-	// Add Assets To Asset Manager
-	LoadLevel(1,&Disunity);
-	AddTexture(&Disunity.assetManager, "truck-image", "C:\\temp\\assets\\images\\truck-ford-right.png");
-	AddTexture(&Disunity.assetManager, "tank-image", "C:\\temp\\assets\\images\\tank-panther-right.png");
+	TransformerComponentAddEntity(&world->components, truck, truckTransformer);
+	RigidBodyComponentAddEntity(&world->components, truck, truckBody);
+	SpriteComponentAddEntity(&world->components, truck, truckSprite);
+}
+
+bool InitEngine(Engine* engine) {
+	engine->DebugPrint = LogDebugMessage;
+	engine->ErrorPrint = LogErrorMessage;
+	engine->fps = FPS;
+	engine->isRunning = true;
+	engine->windowHeight = 800;
+	engine->windowWidth = 800;
+	if (engine->world.inputManager.mode == INPUT_REPLAY) {
+		// Replays Run Headless At The Recorded Tick Rate
+		engine->fps = engine->world.inputManager.replayLog->fps;
+	}
+	else {
+		InitWindow(engine->windowWidth, engine->windowHeight, "Disunity");
+		SetTargetFPS(engine->fps);
+	}
+	engine->world.fps = engine->fps;
+	engine->DebugPrint("Initialized Engine");
+	InitWorld(&engine->world);
 	return true;
 }
 
-bool UninitEngine() {
-	CloseWindow();
+bool UninitEngine(Engine* engine) {
+	if (engine->world.inputManager.mode == INPUT_RECORD) {
+		engine->world.inputManager.log.fps = engine->fps;
+		SaveInputLog(&engine->world.inputManager.log, engine->world.inputManager.logPath);
+	}
+	if (IsWindowReady()) {
+		CloseWindow();
+	}
 	return true;
 }
 
-void ProcessInput(){
-	if (IsKeyDown(KEY_W)) {
+void InitWorld(World* world) {
+	// Add Assets To Asset Manager
+	LoadLevel(1,world);
+	AddTexture(&world->assetManager, "truck-image", "C:\\temp\\assets\\images\\truck-ford-right.png");
+	AddTexture(&world->assetManager, "tank-image", "C:\\temp\\assets\\images\\tank-panther-right.png");
+}
+
+void ApplyInput(World* world, uint8_t keys) {
+	if (keys & INPUT_UP) {
 		// Example Emit Keyboard Event
 		KeyBoardEvent evt = { (KeyboardKey)KEY_W };
-		EmitEvent(&Disunity.eventManager, KEYBOARD, &evt);
-		Transformer* pos = &Disunity.components.TransformComponents.at(4);
+		EmitEvent(&world->eventManager, KEYBOARD, &evt, world->trace);
+		Transformer* pos = &world->components.TransformComponents.at(4);
 		pos->direction.y+=1.0;
-		//DeleteEntity(&Disunity.entityManager, 4);
-		//Animation* animation = &Disunity.components.AnimationComponents.at(4);
+		//DeleteEntity(&world->entityManager, 4);
+		//Animation* animation = &world->components.AnimationComponents.at(4);
 		//animation->shouldLoop = true;
 	}
-	if (IsKeyDown(KEY_A)) {
-		Transformer* pos = &Disunity.components.TransformComponents.at(4);
+	if (keys & INPUT_LEFT) {
+		Transformer* pos = &world->components.TransformComponents.at(4);
 		pos->direction.x += 1.0;
-		//DeleteEntity(&Disunity.entityManager, 4);
-		//Animation* animation = &Disunity.components.AnimationComponents.at(4);
+		//DeleteEntity(&world->entityManager, 4);
+		//Animation* animation = &world->components.AnimationComponents.at(4);
 		//animation->shouldLoop = true;
 	}
-	if (IsKeyDown(KEY_S)) {
-		Transformer* pos = &Disunity.components.TransformComponents.at(4);
+	if (keys & INPUT_DOWN) {
+		Transformer* pos = &world->components.TransformComponents.at(4);
 		pos->direction.y -= 1.0;
-		//DeleteEntity(&Disunity.entityManager, 4);
-		//Animation* animation = &Disunity.components.AnimationComponents.at(4);
+		//DeleteEntity(&world->entityManager, 4);
+		//Animation* animation = &world->components.AnimationComponents.at(4);
 		//animation->shouldLoop = true;
 	}
-	if (IsKeyDown(KEY_D)) {
-		Transformer* pos = &Disunity.components.TransformComponents.at(4);
+	if (keys & INPUT_RIGHT) {
+		Transformer* pos = &world->components.TransformComponents.at(4);
 		pos->direction.x -= 1.0;
 	}
-	if (IsKeyDown(KEY_SPACE)) {
-		DeleteEntity(&Disunity.entityManager, 2);
-		//Animation* animation = &Disunity.components.AnimationComponents.at(4);
+	if (keys & INPUT_ACTION) {
+		DeleteEntity(&world->entityManager, 2);
+		//Animation* animation = &world->components.AnimationComponents.at(4);
 		//animation->shouldLoop = true;
 	}
 }
 
+void ProcessInput(World* world){
+	ApplyInput(world, NextInputKeys(&world->inputManager));
+}
 
-void Update() {
-	// Add pending entities to systems. if we decide to do it like that.
+
+void Update(Engine* engine) {
 	// End Drawing Handle Framerate Waiting For Us
 	// So incrementing by 1 means 1 pixel per second
-	Disunity.deltaTime = (GetTime() - Disunity.previousFrameTime) / 1.0;
-	Disunity.previousFrameTime = GetTime();
-	// Velocity * deltaTime
-	//test.x += 50 * Disunity.deltaTime;
+	double deltaTime = 1.0 / engine->fps;
+	if (engine->world.inputManager.mode == INPUT_LIVE) {
+		deltaTime = (GetTime() - engine->previousFrameTime) / 1.0;
+		engine->previousFrameTime = GetTime();
+	}
+	// Recording And Replaying Use A Fixed Step So Every Tick Can Be Reproduced
+	UpdateWorld(&engine->world, deltaTime);
+}
+
+void UpdateWorld(World* world, double deltaTime) {
+	// Add pending entities to systems. if we decide to do it like that.
+	world->deltaTime = deltaTime;
 	// TODO Add Entries That Are Waiting To Be Added -> Difficult because each could need to have different variables initialized for the component
 	// would need a function that takes the flags of what components the entity needs then or the flags in a loop and initialize it that way?
 	// Clear events
-	ClearEvents(&Disunity.eventManager);
+	ClearEvents(&world->eventManager);
 	// Delete Entities That Are Marked For Deletion
-	PurgeEntities(&Disunity.entityManager,&Disunity.components);
+	PurgeEntities(&world->entityManager,&world->components);
 	// Register Event Callbacks For Systems
-	SubscribeToEvent(&Disunity.eventManager, COLLISION, HealthSystemEventCallback);
-	SubscribeToEvent(&Disunity.eventManager, KEYBOARD, KeyboardControlSystemEventCallback);
+	SubscribeToEvent(&world->eventManager, COLLISION, HealthSystemEventCallback);
+	SubscribeToEvent(&world->eventManager, KEYBOARD, KeyboardControlSystemEventCallback);
 	// Update All Systems Except Render System
-	UpdateMovementSystem(&Disunity.entityManager, &Disunity.components,Disunity.deltaTime);
-	UpdateHealthSystem(&Disunity.entityManager, &Disunity.components);
-	UpdateAnimationSystem(&Disunity.entityManager, &Disunity.components,Disunity.deltaTime);
-	UpdateKeyboardControlSystem(&Disunity.entityManager, &Disunity.components,&Disunity.eventManager);
+	UpdateMovementSystem(&world->entityManager, &world->components,world->deltaTime,world->trace);
+	UpdateHealthSystem(&world->entityManager, &world->components,world->trace);
+	UpdateAnimationSystem(&world->entityManager, &world->components,world->deltaTime,world->trace);
+	UpdateKeyboardControlSystem(&world->entityManager, &world->components,&world->eventManager);
 }
 
-void Render(){
+void Render(World* world){
 	BeginDrawing();
 	ClearBackground(WHITE);
 	// Draw Everything By Invoking Render System
-	//DrawTextureEx(GetTexture(&Disunity.assetManager, "tile-map-image"), { 0.0,0.0 }, 0.0, 4.0, WHITE);
-	UpdateRenderSystem(&Disunity.entityManager, &Disunity.components,&Disunity.assetManager);
+	//DrawTextureEx(GetTexture(&world->assetManager, "tile-map-image"), { 0.0,0.0 }, 0.0, 4.0, WHITE);
+	UpdateRenderSystem(&world->entityManager, &world->components,&world->assetManager,world->trace);
 	// Debugging BoxCollision By Drawing Boxes
-	UpdateDebugBoxCollisionsSystem(&Disunity.entityManager, &Disunity.components);
+	UpdateDebugBoxCollisionsSystem(&world->entityManager, &world->components,world->trace);
 	EndDrawing();
 }
 
-void EngineLoop() {
+void EngineLoop(Engine* engine) {
+	World* world = &engine->world;
 	while (!WindowShouldClose()) {
-		ProcessInput();
-		Update();
-		Render();
+		BeginMemoryFrame(&world->telemetry);
+		ProcessInput(world);
+		Update(engine);
+		EndMemoryFrame(&world->telemetry);
+		if (world->inputManager.mode == INPUT_RECORD) {
+			EndInputTick(&world->inputManager, HashWorld(&world->entityManager, &world->components));
+		}
+		Render(world);
 	}
 }
+
+// One Fixed Step Of A Headless World, Returns False If It Diverged From Its Recorded Session
+bool StepWorld(World* world) {
+	BeginMemoryFrame(&world->telemetry);
+	ProcessInput(world);
+	UpdateWorld(world, 1.0 / world->fps);
+	EndMemoryFrame(&world->telemetry);
+	uint64_t hash = 0;
+	if (world->inputManager.mode == INPUT_REPLAY) {
+		hash = HashWorld(&world->entityManager, &world->components);
+	}
+	return EndInputTick(&world->inputManager, hash);
+}
+
+// Headless Replay Of A Recorded Session, Doubles As A Benchmark And A Determinism Check
+int ReplayWorld(World* world) {
+	InputManager* input = &world->inputManager;
+	// Per Tick Prints Would Dominate The Timings
+	world->trace = false;
+	double totalMicroseconds = 0.0;
+	double worstMicroseconds = 0.0;
+	for (uint32_t i = 0; i < input->replayLog->tickCount; i++) {
+		auto start = std::chrono::high_resolution_clock::now();
+		bool matched = StepWorld(world);
+		auto stop = std::chrono::high_resolution_clock::now();
+		double tickMicroseconds = std::chrono::duration<double, std::micro>(stop - start).count();
+		totalMicroseconds += tickMicroseconds;
+		worstMicroseconds = std::max(worstMicroseconds, tickMicroseconds);
+		if (!matched) {
+			return 1;
+		}
+		if (world->telemetry.dumpInterval && input->tick % world->telemetry.dumpInterval == 0) {
+			MemoryReport report = SampleMemory(world);
+			PrintMemoryReport(&report);
+			ResetMemoryReportWindow(&world->telemetry, &report);
+		}
+	}
+	// Final Report Unless The Last Tick Was Already Dumped
+	if (world->telemetry.framesSinceReport) {
+		MemoryReport report = SampleMemory(world);
+		PrintMemoryReport(&report);
+		ResetMemoryReportWindow(&world->telemetry, &report);
+	}
+	fprintf(stderr, "DISUNITY:::DEBUG::: Replayed %u Ticks Total %.1fus Avg %.2fus Worst %.2fus\n", input->replayLog->tickCount,
+		totalMicroseconds, input->replayLog->tickCount ? totalMicroseconds / input->replayLog->tickCount : 0.0, worstMicroseconds);
+	return 0;
+}
+
+// World Host Worker -> Waits For A Tick Then Claims Worlds One At A Time Until None Are Left
+void WorldHostWorker(WorldHost* host) {
+	uint64_t seenTick = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(host->mutex);
+			host->tickStart.wait(lock, [&] { return host->shuttingDown || host->tick != seenTick; });
+			if (host->shuttingDown) return;
+			seenTick = host->tick;
+		}
+		// A World Is Only Ever Touched By The Worker That Claimed It This Tick
+		for (size_t i = host->nextWorld.fetch_add(1); i < host->worlds.size(); i = host->nextWorld.fetch_add(1)) {
+			World* world = &host->worlds[i];
+			if (world->diverged) continue;
+			auto start = std::chrono::high_resolution_clock::now();
+			bool matched = StepWorld(world);
+			auto stop = std::chrono::high_resolution_clock::now();
+			world->stepMicroseconds += std::chrono::duration<double, std::micro>(stop - start).count();
+			world->stepCount++;
+			if (!matched) {
+				world->diverged = true;
+			}
+		}
+		{
+			std::lock_guard<std::mutex> lock(host->mutex);
+			host->busyWorkers--;
+		}
+		host->tickDone.notify_one();
+	}
+}
+
+void StartWorldHost(WorldHost* host, uint32_t threadCount) {
+	for (uint32_t i = 0; i < threadCount; i++) {
+		host->workers.push_back(std::thread(WorldHostWorker, host));
+	}
+}
+
+void StopWorldHost(WorldHost* host) {
+	{
+		std::lock_guard<std::mutex> lock(host->mutex);
+		host->shuttingDown = true;
+	}
+	host->tickStart.notify_all();
+	for (auto& worker : host->workers) {
+		worker.join();
+	}
+	host->workers.clear();
+}
+
+// Steps Every World Once And Returns When All Of Them Are Done
+void StepWorlds(WorldHost* host) {
+	{
+		std::lock_guard<std::mutex> lock(host->mutex);
+		host->nextWorld = 0;
+		host->busyWorkers = (uint32_t)host->workers.size();
+		host->tick++;
+	}
+	host->tickStart.notify_all();
+	std::unique_lock<std::mutex> lock(host->mutex);
+	host->tickDone.wait(lock, [&] { return host->busyWorkers == 0; });
+}
+
+// Sums The Memory Reports Of Every World Into One, Then Starts A New Report Window For Each
+void DumpWorldsMemory(WorldHost* host) {
+	MemoryReport total = {};
+	for (World& world : host->worlds) {
+		MemoryReport report = SampleMemory(&world);
+		AddMemoryReport(&total, &report);
+		ResetMemoryReportWindow(&world.telemetry, &report);
+	}
+	total.frame = host->tick;
+	PrintMemoryReport(&total);
+}
+
+// Runs worldCount Worlds On threadCount Threads And Reports How Many Worlds One Core Sustains At tickRate
+// With A Log Every World Replays It And Checks Its Hashes, So Any Leak Of State Between Worlds Shows Up As Divergence
+int BenchmarkWorlds(uint32_t worldCount, uint32_t threadCount, uint32_t tickRate, uint32_t ticks, uint32_t dumpInterval, const InputLog* log) {
+	// A Replayed Session Only Matches Its Hashes At The Rate It Was Recorded At
+	if (log) {
+		if (tickRate && tickRate != log->fps) {
+			fprintf(stderr, "DISUNITY:::ERROR::: --bench-rate %u Does Not Match The Recorded Rate %u\n", tickRate, log->fps);
+			return 1;
+		}
+		tickRate = log->fps;
+		ticks = log->tickCount;
+	}
+	if (!tickRate) {
+		tickRate = FPS;
+	}
+	WorldHost host;
+	for (uint32_t i = 0; i < worldCount; i++) {
+		host.worlds.emplace_back();
+		World* world = &host.worlds.back();
+		world->id = i;
+		world->fps = tickRate;
+		world->trace = false;
+		world->inputManager.mode = INPUT_NONE;
+		if (log) {
+			world->inputManager.mode = INPUT_REPLAY;
+			world->inputManager.replayLog = log;
+		}
+		InitWorld(world);
+	}
+	StartWorldHost(&host, threadCount);
+	double budgetMicroseconds = 1000000.0 / tickRate;
+	double totalMicroseconds = 0.0;
+	double worstMicroseconds = 0.0;
+	uint32_t ticksOverBudget = 0;
+	for (uint32_t i = 0; i < ticks; i++) {
+		auto start = std::chrono::high_resolution_clock::now();
+		StepWorlds(&host);
+		auto stop = std::chrono::high_resolution_clock::now();
+		double tickMicroseconds = std::chrono::duration<double, std::micro>(stop - start).count();
+		totalMicroseconds += tickMicroseconds;
+		worstMicroseconds = std::max(worstMicroseconds, tickMicroseconds);
+		if (tickMicroseconds > budgetMicroseconds) ticksOverBudget++;
+		// Workers Are Parked Between Ticks So The Worlds Can Be Read Here
+		if (dumpInterval && host.tick % dumpInterval == 0) {
+			DumpWorldsMemory(&host);
+		}
+	}
+	StopWorldHost(&host);
+	if (!dumpInterval || host.tick % dumpInterval != 0) {
+		DumpWorldsMemory(&host);
+	}
+	uint32_t divergedWorlds = 0;
+	uint64_t stepCount = 0;
+	double stepMicroseconds = 0.0;
+	for (const World& world : host.worlds) {
+		if (world.diverged) divergedWorlds++;
+		stepCount += world.stepCount;
+		stepMicroseconds += world.stepMicroseconds;
+	}
+	// One Core Steps A World In averageStep, A World Needs tickRate Steps Per Second
+	double averageStepMicroseconds = stepCount ? stepMicroseconds / stepCount : 0.0;
+	double worldsPerCore = averageStepMicroseconds > 0.0 ? 1000000.0 / (averageStepMicroseconds * tickRate) : 0.0;
+	fprintf(stderr, "DISUNITY:::BENCH::: %u Worlds %u Threads %u Ticks At %uHz\n", worldCount, threadCount, ticks, tickRate);
+	fprintf(stderr, "DISUNITY:::BENCH::: Tick Avg %.2fus Worst %.2fus Budget %.2fus Over Budget %u\n",
+		ticks ? totalMicroseconds / ticks : 0.0, worstMicroseconds, budgetMicroseconds, ticksOverBudget);
+	fprintf(stderr, "DISUNITY:::BENCH::: World Step Avg %.2fus Worlds Per Core %.1f Diverged %u\n", averageStepMicroseconds, worldsPerCore, divergedWorlds);
+	return divergedWorlds ? 1 : 0;
+}
 //https://gamedev.stackexchange.com/questions/152080/how-do-components-access-one-another-in-a-component-based-entity-system/152093#152093
 //https://gamedev.stackexchange.com/questions/172584/how-could-i-implement-an-ecs-in-c
 
 int main(int argc, char** argv)
 {
 	// Stopped At Managing Assets In Course Displaying Textures
-	InitEngine();
-	EngineLoop();
-	UninitEngine();
+	// Disunity.exe --record session.dsin | --replay session.dsin [--memory-every ticks]
+	// Disunity.exe --bench-worlds count [--bench-threads count] [--bench-rate hz] [--bench-ticks count] [--memory-every ticks] [--replay session.dsin]
+	Engine Disunity;
+	uint32_t benchWorlds = 0;
+	uint32_t benchThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	uint32_t benchRate = 0; // 0 -> the recorded rate with --replay, FPS otherwise
+	uint32_t benchTicks = FPS * 10;
+	for (int i = 1; i + 1 < argc; i++) {
+		if (strcmp(argv[i], "--record") == 0) {
+			Disunity.world.inputManager.mode = INPUT_RECORD;
+			Disunity.world.inputManager.logPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--replay") == 0) {
+			Disunity.world.inputManager.mode = INPUT_REPLAY;
+			Disunity.world.inputManager.logPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--memory-every") == 0) {
+			Disunity.world.telemetry.dumpInterval = (uint32_t)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--bench-worlds") == 0) {
+			benchWorlds = (uint32_t)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--bench-threads") == 0) {
+			benchThreads = std::max(atoi(argv[++i]), 1);
+		}
+		else if (strcmp(argv[i], "--bench-rate") == 0) {
+			benchRate = (uint32_t)std::max(atoi(argv[++i]), 1);
+		}
+		else if (strcmp(argv[i], "--bench-ticks") == 0) {
+			benchTicks = (uint32_t)atoi(argv[++i]);
+		}
+	}
+	InputLog replayLog;
+	if (Disunity.world.inputManager.mode == INPUT_REPLAY) {
+		if (!LoadInputLog(&replayLog, Disunity.world.inputManager.logPath)) {
+			return 1;
+		}
+		Disunity.world.inputManager.replayLog = &replayLog;
+	}
+	if (benchWorlds) {
+		const InputLog* log = Disunity.world.inputManager.replayLog;
+		return BenchmarkWorlds(benchWorlds, benchThreads, benchRate, benchTicks, Disunity.world.telemetry.dumpInterval, log);
+	}
+	if (Disunity.world.inputManager.mode == INPUT_REPLAY) {
+		InitEngine(&Disunity);
+		int result = ReplayWorld(&Disunity.world);
+		UninitEngine(&Disunity);
+		return result;
+	}
+	InitEngine(&Disunity);
+	EngineLoop(&Disunity);
+	UninitEngine(&Disunity);
 	return 0;
 }
 
-
 // 
 /*The main loop should iterate over systems, not entities.Each system iterates only over the entities that share the cross section of components that are relevant for that particular system.This prevents systems from wasting cycles on entities that have no relevance to the system.*/
\ No newline at end of file